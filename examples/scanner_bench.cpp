@@ -0,0 +1,331 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <optional>
+#include <random>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <wincpp/patterns/scanner.hpp>
+
+using namespace wincpp::patterns;
+
+namespace
+{
+    using algorithm_t = scanner::algorithm_t;
+
+    /// <summary>
+    /// The options of the benchmark.
+    /// </summary>
+    struct options_t
+    {
+        std::size_t size = 4 << 20;
+        std::size_t reps = 3;
+        bool check_only = false;
+    };
+
+    /// <summary>
+    /// An algorithm under test.
+    /// </summary>
+    struct algorithm_entry_t
+    {
+        const char* name;
+        std::vector< std::uintptr_t > ( *find_all )( const pattern_t& pattern, std::span< std::uint8_t > buffer );
+        std::optional< std::uintptr_t > ( *find )( const pattern_t& pattern, std::span< std::uint8_t > buffer );
+    };
+
+    template< algorithm_t algorithm >
+    constexpr algorithm_entry_t entry( const char* name ) noexcept
+    {
+        return { name,
+                 []( const pattern_t& pattern, std::span< std::uint8_t > buffer ) { return scanner::find_all< algorithm >( buffer, pattern ); },
+                 []( const pattern_t& pattern, std::span< std::uint8_t > buffer ) { return scanner::find< algorithm >( buffer, pattern ); } };
+    }
+
+    /// <summary>
+    /// Every algorithm. The first one is the reference the others are checked against.
+    /// </summary>
+    constexpr std::array algorithms = {
+        entry< algorithm_t::naive_t >( "naive" ), entry< algorithm_t::bmh_t >( "bmh" ),   entry< algorithm_t::raita_t >( "raita" ),
+        entry< algorithm_t::tbm_t >( "tbm" ),     entry< algorithm_t::simd_t >( "simd" ),
+    };
+
+    /// <summary>
+    /// Generates a corpus of uniformly random bytes.
+    /// </summary>
+    std::vector< std::uint8_t > random_corpus( std::size_t size, std::mt19937_64& rng )
+    {
+        std::vector< std::uint8_t > corpus( size );
+
+        for ( auto& byte : corpus )
+            byte = static_cast< std::uint8_t >( rng() );
+
+        return corpus;
+    }
+
+    /// <summary>
+    /// Generates a corpus that resembles x64 code: functions made of common instruction encodings, small displacements and int3 padding.
+    /// </summary>
+    std::vector< std::uint8_t > code_corpus( std::size_t size, std::mt19937_64& rng )
+    {
+        // Instruction templates. Zero bytes after the opcode are filled with an operand.
+        constexpr std::array< std::string_view, 14 > instructions = {
+            std::string_view( "\x48\x89\x5C\x24\x08", 5 ),      // mov [rsp+8], rbx
+            std::string_view( "\x48\x83\xEC\x20", 4 ),          // sub rsp, 20h
+            std::string_view( "\x48\x8B\x05\x00\x00\x00\x00", 7 ),  // mov rax, [rip+disp]
+            std::string_view( "\x48\x8D\x0D\x00\x00\x00\x00", 7 ),  // lea rcx, [rip+disp]
+            std::string_view( "\xE8\x00\x00\x00\x00", 5 ),      // call rel32
+            std::string_view( "\x48\x85\xC0", 3 ),              // test rax, rax
+            std::string_view( "\x74\x00", 2 ),                  // jz rel8
+            std::string_view( "\x48\x8B\xCB", 3 ),              // mov rcx, rbx
+            std::string_view( "\x33\xC0", 2 ),                  // xor eax, eax
+            std::string_view( "\x48\x89\x44\x24\x00", 5 ),      // mov [rsp+disp8], rax
+            std::string_view( "\x8B\x4F\x00", 3 ),              // mov ecx, [rdi+disp8]
+            std::string_view( "\xB9\x00\x00\x00\x00", 5 ),      // mov ecx, imm32
+            std::string_view( "\x0F\xB6\x47\x00", 4 ),          // movzx eax, byte ptr [rdi+disp8]
+            std::string_view( "\xFF\x15\x00\x00\x00\x00", 6 ),  // call [rip+disp]
+        };
+
+        constexpr std::string_view epilogue( "\x48\x83\xC4\x20\x5B\xC3", 6 );
+
+        std::vector< std::uint8_t > corpus;
+        corpus.reserve( size + 64 );
+
+        while ( corpus.size() < size )
+        {
+            const auto count = 4 + rng() % 40;
+
+            for ( std::size_t i = 0; i < count; ++i )
+            {
+                const auto instruction = instructions[ rng() % instructions.size() ];
+
+                for ( std::size_t j = 0; j < instruction.size(); ++j )
+                {
+                    // Operands are mostly small values, so zero and 0xFF dominate their upper bytes.
+                    if ( j > 0 && instruction[ j ] == 0 )
+                        corpus.push_back( j == 1 || rng() % 4 == 0 ? static_cast< std::uint8_t >( rng() ) : ( rng() % 3 ? 0x00 : 0xFF ) );
+                    else
+                        corpus.push_back( static_cast< std::uint8_t >( instruction[ j ] ) );
+                }
+            }
+
+            corpus.insert( corpus.end(), epilogue.begin(), epilogue.end() );
+
+            // Functions are aligned to 16 bytes with int3.
+            while ( corpus.size() % 16 )
+                corpus.push_back( 0xCC );
+        }
+
+        corpus.resize( size );
+        return corpus;
+    }
+
+    /// <summary>
+    /// Creates a pattern from the bytes at a random location of the corpus, replacing bytes with wildcards at the given density. The first and
+    /// last bytes are always fixed.
+    /// </summary>
+    pattern_t make_pattern( const std::vector< std::uint8_t >& corpus, std::size_t length, double wildcards, std::mt19937_64& rng )
+    {
+        const auto offset = rng() % ( corpus.size() - length );
+
+        std::string aob( reinterpret_cast< const char* >( corpus.data() + offset ), length );
+        std::string mask( length, 'x' );
+
+        std::bernoulli_distribution wildcard( wildcards );
+
+        for ( std::size_t i = 1; i + 1 < length; ++i )
+        {
+            if ( wildcard( rng ) )
+                mask[ i ] = '?';
+        }
+
+        return pattern_t( aob.data(), mask );
+    }
+
+    /// <summary>
+    /// Writes the fixed bytes of the pattern at `count` random locations of the buffer.
+    /// </summary>
+    void plant( std::vector< std::uint8_t >& buffer, const pattern_t& pattern, std::size_t count, std::mt19937_64& rng )
+    {
+        for ( std::size_t n = 0; n < count; ++n )
+        {
+            const auto offset = rng() % ( buffer.size() - pattern.size() + 1 );
+
+            for ( std::size_t i = 0; i < pattern.size(); ++i )
+            {
+                if ( pattern.fixed( i ) )
+                    buffer[ offset + i ] = pattern.bytes()[ i ];
+            }
+        }
+    }
+
+    /// <summary>
+    /// Compares every algorithm against the reference on small buffers with tiny alphabets, where shift tables are most likely to skip a match.
+    /// </summary>
+    /// <returns>The number of mismatches.</returns>
+    std::size_t fuzz( std::size_t iterations, std::mt19937_64& rng )
+    {
+        std::size_t failures = 0;
+
+        for ( std::size_t n = 0; n < iterations; ++n )
+        {
+            const auto alphabet = 1 + rng() % 4;
+            std::vector< std::uint8_t > buffer( rng() % 512 );
+
+            for ( auto& byte : buffer )
+                byte = static_cast< std::uint8_t >( rng() % alphabet );
+
+            const auto length = 1 + rng() % 150;
+            const auto density = ( rng() % 4 ) * 0.2;
+
+            std::string aob( length, '\0' );
+            std::string mask( length, 'x' );
+            std::bernoulli_distribution wildcard( density );
+
+            for ( std::size_t i = 0; i < length; ++i )
+            {
+                aob[ i ] = static_cast< char >( rng() % alphabet );
+
+                if ( wildcard( rng ) )
+                    mask[ i ] = '?';
+            }
+
+            const pattern_t pattern( aob.data(), mask );
+
+            if ( buffer.size() >= length && rng() % 2 )
+                plant( buffer, pattern, 1 + rng() % 3, rng );
+
+            const auto expected = algorithms[ 0 ].find_all( pattern, buffer );
+            const auto first = algorithms[ 0 ].find( pattern, buffer );
+
+            for ( std::size_t a = 1; a < algorithms.size(); ++a )
+            {
+                if ( algorithms[ a ].find_all( pattern, buffer ) != expected || algorithms[ a ].find( pattern, buffer ) != first )
+                {
+                    if ( failures++ < 10 )
+                        std::printf( "[-] %s disagrees with %s: %s\n", algorithms[ a ].name, algorithms[ 0 ].name, pattern.to_string().c_str() );
+                }
+            }
+        }
+
+        return failures;
+    }
+
+    /// <summary>
+    /// Runs every algorithm on every combination of pattern length, wildcard density and hit density over the corpus.
+    /// </summary>
+    /// <returns>The number of algorithms that disagreed with the reference.</returns>
+    std::size_t bench( const char* name, const std::vector< std::uint8_t >& corpus, const options_t& options, std::mt19937_64& rng )
+    {
+        constexpr std::array< std::size_t, 6 > lengths = { 4, 8, 16, 32, 64, 128 };
+        constexpr std::array< double, 3 > densities = { 0.0, 0.25, 0.5 };
+
+        // Planted occurrences per MB.
+        constexpr std::array< std::size_t, 3 > hits = { 0, 4, 1024 };
+
+        std::size_t failures = 0;
+        std::vector< std::uint8_t > buffer;
+
+        for ( const auto length : lengths )
+        {
+            for ( const auto density : densities )
+            {
+                for ( const auto hit : hits )
+                {
+                    const auto pattern = make_pattern( corpus, length, density, rng );
+
+                    buffer = corpus;
+                    plant( buffer, pattern, hit * buffer.size() / ( 1 << 20 ), rng );
+
+                    const auto expected = algorithms[ 0 ].find_all( pattern, buffer );
+
+                    for ( const auto& algorithm : algorithms )
+                    {
+                        auto best = std::chrono::nanoseconds::max();
+                        std::vector< std::uintptr_t > results;
+
+                        for ( std::size_t rep = 0; rep < options.reps; ++rep )
+                        {
+                            const auto start = std::chrono::steady_clock::now();
+                            results = algorithm.find_all( pattern, buffer );
+                            best = std::min< std::chrono::nanoseconds >( best, std::chrono::steady_clock::now() - start );
+                        }
+
+                        const auto ok = results == expected;
+                        const auto ns = static_cast< double >( best.count() );
+
+                        if ( !ok )
+                            ++failures;
+
+                        std::printf( "%-6s %4zu %4.0f%% %5zu  %-6s %8.2f GB/s  ", name, length, density * 100, hit, algorithm.name,
+                                     static_cast< double >( buffer.size() ) / ns );
+
+                        if ( results.empty() )
+                            std::printf( "%12s ns/match", "-" );
+                        else
+                            std::printf( "%12.1f ns/match", ns / static_cast< double >( results.size() ) );
+
+                        std::printf( "  %8zu matches%s\n", results.size(), ok ? "" : "  MISMATCH" );
+                    }
+                }
+            }
+        }
+
+        return failures;
+    }
+
+    /// <summary>
+    /// Parses the command line: --size <MB>, --reps <n> and --check (only run the correctness checks).
+    /// </summary>
+    options_t parse( int argc, char** argv )
+    {
+        options_t options;
+
+        for ( int i = 1; i < argc; ++i )
+        {
+            const std::string_view arg( argv[ i ] );
+
+            if ( arg == "--size" && i + 1 < argc )
+                options.size = std::max< std::size_t >( 1, std::strtoull( argv[ ++i ], nullptr, 10 ) ) << 20;
+            else if ( arg == "--reps" && i + 1 < argc )
+                options.reps = std::max< std::size_t >( 1, std::strtoull( argv[ ++i ], nullptr, 10 ) );
+            else if ( arg == "--check" )
+                options.check_only = true;
+            else
+                std::printf( "[-] Unknown argument: %s\n", argv[ i ] );
+        }
+
+        return options;
+    }
+}  // namespace
+
+int main( int argc, char** argv )
+{
+    const auto options = parse( argc, argv );
+
+    std::mt19937_64 rng( 0x77696E637070 );
+
+    std::size_t failures = fuzz( 20000, rng );
+    std::printf( "[+] Fuzzed every algorithm against %s: %zu mismatches\n", algorithms[ 0 ].name, failures );
+
+    if ( !options.check_only )
+    {
+        std::printf( "corpus  len  wild  hits  alg        throughput      time per match\n" );
+
+        failures += bench( "random", random_corpus( options.size, rng ), options, rng );
+        failures += bench( "x64", code_corpus( options.size, rng ), options, rng );
+    }
+
+    if ( failures != 0 )
+    {
+        std::printf( "[-] %zu mismatches against the reference\n", failures );
+        return 1;
+    }
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+
+#if defined( _M_X64 ) || defined( _M_IX86 ) || defined( __x86_64__ ) || defined( __i386__ )
+#define WINCPP_X86 1
+#endif
+
+// MSVC lets any function use any intrinsic, GCC and Clang need the instruction set enabled per function.
+#if defined( _MSC_VER ) && !defined( __clang__ )
+#define WINCPP_TARGET( isa )
+#else
+#define WINCPP_TARGET( isa ) __attribute__( ( target( isa ) ) )
+#endif
+
+namespace wincpp::core
+{
+    /// <summary>
+    /// The instruction set extensions supported by the host processor (and enabled by the operating system).
+    /// </summary>
+    struct cpu_features_t final
+    {
+        /// <summary>
+        /// Returns the features of the host processor. These are only queried once.
+        /// </summary>
+        static const cpu_features_t& get() noexcept;
+
+        /// <summary>
+        /// Whether the processor supports SSE4.2.
+        /// </summary>
+        bool sse42 = false;
+
+        /// <summary>
+        /// Whether the processor supports AVX2.
+        /// </summary>
+        bool avx2 = false;
+
+       private:
+        /// <summary>
+        /// Queries the host processor.
+        /// </summary>
+        cpu_features_t() noexcept;
+    };
+}  // namespace wincpp::core
\ No newline at end of file
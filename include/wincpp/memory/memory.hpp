@@ -6,15 +6,20 @@
 
 #include <Psapi.h>
 
+#include <algorithm>
+#include <functional>
 #include <optional>
+#include <span>
 #include <vector>
 
+#include "wincpp/patterns/scanner.hpp"
+
 namespace wincpp::patterns
 {
     /// <summary>
-    /// Forward declaration of the pattern_t struct.
+    /// Forward declaration of the multi_scanner class.
     /// </summary>
-    struct pattern_t;
+    class multi_scanner;
 }  // namespace wincpp::patterns
 
 namespace wincpp::memory
@@ -149,9 +154,62 @@ namespace wincpp::memory
         /// <returns>The relative locations.</returns>
         std::vector< std::uintptr_t > find_all( const patterns::pattern_t& pattern ) const noexcept;
 
+        /// <summary>
+        /// Searches for the compiled pattern in the memory object.
+        /// </summary>
+        /// <param name="pattern">The compiled pattern to search for.</param>
+        /// <returns>The relative location.</returns>
+        template< patterns::scanner::algorithm_t algorithm >
+        std::optional< std::uintptr_t > find( const patterns::scanner::compiled< algorithm >& pattern ) const noexcept;
+
+        /// <summary>
+        /// Searches for all occurrences of the compiled pattern in the memory object.
+        /// </summary>
+        /// <param name="pattern">The compiled pattern to search for.</param>
+        /// <returns>The relative locations.</returns>
+        template< patterns::scanner::algorithm_t algorithm >
+        std::vector< std::uintptr_t > find_all( const patterns::scanner::compiled< algorithm >& pattern ) const noexcept;
+
+        /// <summary>
+        /// Searches for the first occurrence of every pattern of the scanner. Each region is read and scanned once for all patterns.
+        /// </summary>
+        /// <param name="scanner">The compiled patterns to search for.</param>
+        /// <returns>The location of each pattern, in the order the patterns were compiled.</returns>
+        std::vector< std::optional< std::uintptr_t > > find( const patterns::multi_scanner& scanner ) const noexcept;
+
+        /// <summary>
+        /// Searches for all occurrences of every pattern of the scanner. Each region is read and scanned once for all patterns.
+        /// </summary>
+        /// <param name="scanner">The compiled patterns to search for.</param>
+        /// <returns>The locations of each pattern, in the order the patterns were compiled.</returns>
+        std::vector< std::vector< std::uintptr_t > > find_all( const patterns::multi_scanner& scanner ) const noexcept;
+
         memory_factory factory;
 
+        /// <summary>
+        /// The default for `scan_budget` (1 MB).
+        /// </summary>
+        constexpr static std::size_t default_scan_budget = 1 << 20;
+
+        /// <summary>
+        /// The largest number of bytes read at once when scanning. Larger regions are streamed in chunks that overlap by the pattern size minus
+        /// one, so matches crossing a chunk boundary are still found. Zero reads every region as a whole.
+        /// </summary>
+        std::size_t scan_budget = default_scan_budget;
+
        private:
+        /// <summary>
+        /// The callback for scanned chunks. It receives the address of the chunk, its bytes, and the number of leading offsets the chunk is
+        /// responsible for (matches starting after it are reported again by the next chunk). Returning false stops the scan.
+        /// </summary>
+        using chunk_callback = std::function< bool( std::uintptr_t, std::span< std::uint8_t >, std::size_t ) >;
+
+        /// <summary>
+        /// Reads every valid region of the memory object in chunks of at most `scan_budget` bytes and passes them to the callback.
+        /// </summary>
+        /// <param name="overlap">The number of bytes consecutive chunks share (the longest pattern minus one).</param>
+        /// <param name="callback">The callback.</param>
+        void scan_regions( std::size_t overlap, const chunk_callback& callback ) const noexcept;
 
         bool is_valid_region( const memory::region_t& region ) const noexcept;
 
@@ -174,6 +232,53 @@ namespace wincpp::memory
         return _address <= address && address <= _address + _size;
     }
 
+    template< patterns::scanner::algorithm_t algorithm >
+    std::optional< std::uintptr_t > memory_t::find( const patterns::scanner::compiled< algorithm >& pattern ) const noexcept
+    {
+        std::optional< std::uintptr_t > result;
+
+        // Earlier offsets were covered by the previous chunks, so the first match of any chunk is the first one overall.
+        scan_regions(
+            pattern.pattern().size() - 1,
+            [ & ]( std::uintptr_t address, std::span< std::uint8_t > bytes, std::size_t )
+            {
+                if ( const auto found = pattern.find( bytes ) )
+                    result = address + *found;
+
+                return !result;
+            } );
+
+        return result;
+    }
+
+    template< patterns::scanner::algorithm_t algorithm >
+    std::vector< std::uintptr_t > memory_t::find_all( const patterns::scanner::compiled< algorithm >& pattern ) const noexcept
+    {
+        std::vector< std::uintptr_t > results;
+        std::uintptr_t next = 0;
+
+        scan_regions(
+            pattern.pattern().size() - 1,
+            [ & ]( std::uintptr_t address, std::span< std::uint8_t > bytes, std::size_t window )
+            {
+                // Resume where the previous match ended, so the results don't depend on where the chunks are split.
+                const auto skip = next > address ? std::min< std::size_t >( next - address, bytes.size() ) : 0;
+
+                for ( const auto& result : pattern.find_all( bytes.subspan( skip ) ) )
+                {
+                    if ( skip + result >= window )
+                        break;
+
+                    results.push_back( address + skip + result );
+                    next = results.back() + pattern.pattern().size();
+                }
+
+                return true;
+            } );
+
+        return results;
+    }
+
     inline std::shared_ptr< std::uint8_t[] > memory_t::read( std::uintptr_t address, std::size_t size ) const
     {
         return factory.read( address, size );
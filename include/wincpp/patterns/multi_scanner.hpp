@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "wincpp/patterns/pattern.hpp"
+
+namespace wincpp::patterns
+{
+    /// <summary>
+    /// Scans a buffer of bytes for a whole set of patterns in a single pass.
+    /// </summary>
+    /// <remarks>
+    /// The longest run of fixed bytes of every pattern is compiled into one Aho-Corasick automaton. Each hit of a run is a candidate that is then
+    /// verified against the full (masked) pattern, so the scan time depends on the size of the buffer and not on the number of patterns.
+    /// </remarks>
+    class multi_scanner final
+    {
+       public:
+        /// <summary>
+        /// Compiles the patterns into a new multi scanner.
+        /// </summary>
+        /// <param name="patterns">The patterns to search for. Results are reported in the same order.</param>
+        explicit multi_scanner( std::span< const pattern_t > patterns );
+
+        /// <summary>
+        /// Searches for the first occurrence of every pattern in the buffer.
+        /// </summary>
+        /// <param name="buffer">The buffer to search in.</param>
+        /// <returns>The relative location of each pattern, if it was found.</returns>
+        std::vector< std::optional< std::uintptr_t > > find( std::span< std::uint8_t > buffer ) const noexcept;
+
+        /// <summary>
+        /// Searches for all occurrences of every pattern in the buffer. Like `scanner::find_all`, occurrences of one pattern don't overlap.
+        /// </summary>
+        /// <param name="buffer">The buffer to search in.</param>
+        /// <returns>The relative locations of each pattern.</returns>
+        std::vector< std::vector< std::uintptr_t > > find_all( std::span< std::uint8_t > buffer ) const noexcept;
+
+        /// <summary>
+        /// Invokes the callback for every occurrence of every pattern in the buffer, including overlapping ones. Occurrences of one pattern are
+        /// reported in increasing order.
+        /// </summary>
+        /// <param name="buffer">The buffer to search in.</param>
+        /// <param name="callback">Receives the index of the pattern and the relative location. Returning false stops the scan.</param>
+        void find_each( std::span< std::uint8_t > buffer, const std::function< bool( std::size_t, std::uintptr_t ) >& callback ) const noexcept;
+
+        /// <summary>
+        /// Gets the compiled patterns.
+        /// </summary>
+        const std::vector< pattern_t >& patterns() const noexcept;
+
+        /// <summary>
+        /// Gets the number of compiled patterns.
+        /// </summary>
+        std::size_t size() const noexcept;
+
+       private:
+        /// <summary>
+        /// The fixed run of a pattern that is inserted into the automaton.
+        /// </summary>
+        struct keyword_t
+        {
+            /// <summary>
+            /// The index of the pattern.
+            /// </summary>
+            std::uint32_t pattern;
+
+            /// <summary>
+            /// The index of the last byte of the run within the pattern.
+            /// </summary>
+            std::uint32_t end;
+        };
+
+        /// <summary>
+        /// Walks the automaton over the buffer and invokes the callback for every verified match.
+        /// </summary>
+        /// <returns>False if the callback stopped the scan.</returns>
+        template< typename Callback >
+        bool scan( std::span< std::uint8_t > buffer, Callback&& callback ) const noexcept;
+
+        /// <summary>
+        /// The longest keyword inserted for a single pattern. Longer runs are truncated.
+        /// </summary>
+        constexpr static std::size_t max_keyword = 16;
+
+        std::vector< pattern_t > compiled;
+        std::vector< keyword_t > keywords;
+
+        /// <summary>
+        /// Patterns without any fixed bytes. They match at every position.
+        /// </summary>
+        std::vector< std::uint32_t > unanchored;
+
+        /// <summary>
+        /// The dense transition table of the automaton (256 entries per state).
+        /// </summary>
+        std::vector< std::uint32_t > transitions;
+
+        /// <summary>
+        /// The keywords recognized by each state, stored as offsets into `outputs` (one more entry than there are states).
+        /// </summary>
+        std::vector< std::uint32_t > output_offsets;
+        std::vector< std::uint32_t > outputs;
+    };
+}  // namespace wincpp::patterns
\ No newline at end of file
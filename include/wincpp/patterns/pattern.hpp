@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+#include <cstring>
 #include <memory>
 #include <ostream>
 #include <string>
@@ -10,6 +12,10 @@ namespace wincpp::patterns
     /// <summary>
     /// The class for all patterns. This struct contains the bytes, mask, and size of the pattern.
     /// </summary>
+    /// <remarks>
+    /// Patterns of up to 64 bytes are stored inline, so copying one never allocates. The mask is packed into 64-bit words (one bit per byte) and
+    /// the position of the first and last fixed byte and the number of wildcards are computed once on construction.
+    /// </remarks>
     struct pattern_t
     {
         /// <summary>
@@ -29,7 +35,6 @@ namespace wincpp::patterns
         /// Creates a new pattern from the bytes of the string (each character is a byte).
         /// </summary>
         /// <param name="object">The string.</param>
-        template<>
         pattern_t( const std::string& object ) noexcept : pattern_t( object.data(), object.size() )
         {
         }
@@ -38,7 +43,6 @@ namespace wincpp::patterns
         /// Creates a new pattern from the bytes of the string (each character is a byte).
         /// </summary>
         /// <param name="object">The string.</param>
-        template<>
         pattern_t( const std::string_view& object ) noexcept : pattern_t( object.data(), object.size() )
         {
         }
@@ -60,6 +64,54 @@ namespace wincpp::patterns
         /// <param name="mask"></param>
         pattern_t( const char* const aob, const std::string_view smask ) noexcept;
 
+        /// <summary>
+        /// The number of bytes stored inline. Longer patterns are stored in a single shared heap block.
+        /// </summary>
+        constexpr static std::size_t inline_capacity = 64;
+
+        /// <summary>
+        /// Gets the number of bytes in the pattern.
+        /// </summary>
+        std::size_t size() const noexcept;
+
+        /// <summary>
+        /// Gets the bytes of the pattern. Wildcards are zero.
+        /// </summary>
+        const std::uint8_t* bytes() const noexcept;
+
+        /// <summary>
+        /// Gets the packed mask of the pattern. Bit `i % 64` of word `i / 64` is set if byte `i` is fixed (not a wildcard).
+        /// </summary>
+        const std::uint64_t* mask() const noexcept;
+
+        /// <summary>
+        /// Determines whether the byte at the specified index is fixed (not a wildcard).
+        /// </summary>
+        /// <param name="index">The index of the byte.</param>
+        bool fixed( std::size_t index ) const noexcept;
+
+        /// <summary>
+        /// Gets the number of wildcards in the pattern.
+        /// </summary>
+        std::size_t wildcards() const noexcept;
+
+        /// <summary>
+        /// Gets the index of the first fixed byte, or `size()` if the pattern consists only of wildcards.
+        /// </summary>
+        std::size_t first_fixed() const noexcept;
+
+        /// <summary>
+        /// Gets the index of the last fixed byte, or `size()` if the pattern consists only of wildcards.
+        /// </summary>
+        std::size_t last_fixed() const noexcept;
+
+        /// <summary>
+        /// Determines whether the pattern matches the bytes at the specified location. Wildcards match any byte.
+        /// </summary>
+        /// <param name="data">The bytes to compare against. At least `size()` bytes must be readable.</param>
+        /// <returns>True if every fixed byte of the pattern matches.</returns>
+        bool matches( const std::uint8_t* data ) const noexcept;
+
         /// <summary>
         /// Converts the pattern to a string.
         /// </summary>
@@ -70,22 +122,57 @@ namespace wincpp::patterns
         /// </summary>
         friend std::ostream& operator<<( std::ostream& os, const pattern_t& p ) noexcept;
 
-        std::shared_ptr< std::uint8_t[] > bytes;
-        std::shared_ptr< bool[] > mask;
-        std::size_t size = 0;
+       private:
+        /// <summary>
+        /// Sets the size of the pattern and selects its storage. All bytes are zeroed and marked as wildcards.
+        /// </summary>
+        /// <param name="size">The number of bytes.</param>
+        void allocate( std::size_t size ) noexcept;
+
+        /// <summary>
+        /// Computes the metadata (wildcard count, first and last fixed byte) once the bytes and mask are in place.
+        /// </summary>
+        void finalize() noexcept;
+
+        /// <summary>
+        /// The number of 64-bit mask words needed for the specified number of bytes.
+        /// </summary>
+        constexpr static std::size_t mask_words( std::size_t size ) noexcept
+        {
+            return ( size + 63 ) / 64;
+        }
+
+        std::size_t length = 0;
+        std::size_t wildcard_count = 0;
+        std::size_t first = 0;
+        std::size_t last = 0;
+
+        /// <summary>
+        /// Storage for patterns of up to `inline_capacity` bytes.
+        /// </summary>
+        std::uint64_t inline_mask = 0;
+        std::uint8_t inline_bytes[ inline_capacity ]{};
+
+        /// <summary>
+        /// Storage for longer patterns: the mask words followed by the bytes.
+        /// </summary>
+        std::shared_ptr< std::uint64_t[] > heap;
+
+        std::uint64_t* mutable_mask() noexcept;
+        std::uint8_t* mutable_bytes() noexcept;
     };
 
     template< typename T >
-    inline pattern_t::pattern_t( const T* object, std::size_t size ) noexcept : size( size )
+    inline pattern_t::pattern_t( const T* object, std::size_t size ) noexcept
     {
-        bytes = std::shared_ptr< std::uint8_t[] >( new std::uint8_t[ size ] );
-        mask = std::shared_ptr< bool[] >( new bool[ size ] );
+        allocate( size );
+
+        std::memcpy( mutable_bytes(), object, size );
 
         for ( std::size_t i = 0; i < size; ++i )
-        {
-            bytes[ i ] = reinterpret_cast< const std::uint8_t* >( object )[ i ];
-            mask[ i ] = true;
-        }
+            mutable_mask()[ i / 64 ] |= std::uint64_t( 1 ) << ( i % 64 );
+
+        finalize();
     }
 
     template< typename T >
@@ -93,4 +180,49 @@ namespace wincpp::patterns
     {
     }
 
+    inline std::size_t pattern_t::size() const noexcept
+    {
+        return length;
+    }
+
+    inline const std::uint8_t* pattern_t::bytes() const noexcept
+    {
+        return heap ? reinterpret_cast< const std::uint8_t* >( heap.get() + mask_words( length ) ) : inline_bytes;
+    }
+
+    inline const std::uint64_t* pattern_t::mask() const noexcept
+    {
+        return heap ? heap.get() : &inline_mask;
+    }
+
+    inline bool pattern_t::fixed( std::size_t index ) const noexcept
+    {
+        return ( mask()[ index / 64 ] >> ( index % 64 ) ) & 1;
+    }
+
+    inline std::size_t pattern_t::wildcards() const noexcept
+    {
+        return wildcard_count;
+    }
+
+    inline std::size_t pattern_t::first_fixed() const noexcept
+    {
+        return first;
+    }
+
+    inline std::size_t pattern_t::last_fixed() const noexcept
+    {
+        return last;
+    }
+
+    inline std::uint64_t* pattern_t::mutable_mask() noexcept
+    {
+        return const_cast< std::uint64_t* >( mask() );
+    }
+
+    inline std::uint8_t* pattern_t::mutable_bytes() noexcept
+    {
+        return const_cast< std::uint8_t* >( bytes() );
+    }
+
 }  // namespace wincpp::patterns
\ No newline at end of file
@@ -1,12 +1,19 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
 #include <iostream>
+#include <limits>
 #include <memory>
 #include <optional>
 #include <span>
+#include <thread>
 #include <vector>
 
 #include "wincpp/patterns/pattern.hpp"
+#include "wincpp/patterns/signature.hpp"
 
 namespace wincpp::patterns
 {
@@ -21,6 +28,14 @@ namespace wincpp::patterns
         /// </summary>
         enum class algorithm_t;
 
+        /// <summary>
+        /// A pattern prepared for one algorithm. The tables the algorithm needs are built once, so the same object can be reused for any number of
+        /// buffers, regions, modules or processes.
+        /// </summary>
+        /// <typeparam name="algorithm">The algorithm to use for scanning.</typeparam>
+        template< algorithm_t algorithm >
+        class compiled;
+
         /// <summary>
         /// Searches for the pattern in the buffer.
         /// </summary>
@@ -41,17 +56,109 @@ namespace wincpp::patterns
         template< algorithm_t algorithm >
         static std::vector< std::uintptr_t > find_all( std::span< std::uint8_t > buffer, const pattern_t& pattern ) noexcept;
 
+        /// <summary>
+        /// Searches for the compile time signature in the buffer, using the verifier generated for it.
+        /// </summary>
+        /// <param name="buffer">The buffer to search in.</param>
+        /// <param name="signature">The signature to search for.</param>
+        /// <returns>The relative location.</returns>
+        template< fixed_string_t S >
+        static std::optional< std::uintptr_t > find( std::span< std::uint8_t > buffer, const signature_t< S >& signature ) noexcept;
+
+        /// <summary>
+        /// Searches for all occurrences of the compile time signature in the buffer, using the verifier generated for it.
+        /// </summary>
+        /// <param name="buffer">The buffer to search in.</param>
+        /// <param name="signature">The signature to search for.</param>
+        /// <returns>The relative locations.</returns>
+        template< fixed_string_t S >
+        static std::vector< std::uintptr_t > find_all( std::span< std::uint8_t > buffer, const signature_t< S >& signature ) noexcept;
+
+        /// <summary>
+        /// Searches for the pattern in the buffer on multiple threads. See `compiled::find_parallel`.
+        /// </summary>
+        /// <param name="buffer">The buffer to search in.</param>
+        /// <param name="pattern">The pattern to search for.</param>
+        /// <param name="threads">The maximum number of threads. Zero uses one per hardware thread.</param>
+        /// <returns>The relative location.</returns>
+        template< algorithm_t algorithm >
+        static std::optional< std::uintptr_t > find_parallel( std::span< std::uint8_t > buffer, const pattern_t& pattern, std::size_t threads = 0 );
+
+        /// <summary>
+        /// Searches for all occurrences of the pattern in the buffer on multiple threads. See `compiled::find_all_parallel`.
+        /// </summary>
+        /// <param name="buffer">The buffer to search in.</param>
+        /// <param name="pattern">The pattern to search for.</param>
+        /// <param name="threads">The maximum number of threads. Zero uses one per hardware thread.</param>
+        /// <returns>The relative locations.</returns>
+        template< algorithm_t algorithm >
+        static std::vector< std::uintptr_t > find_all_parallel( std::span< std::uint8_t > buffer, const pattern_t& pattern, std::size_t threads = 0 );
+
+        /// <summary>
+        /// The smallest shard handed to a thread by the parallel searches. Shards are also scanned in blocks of this size, so a shard can stop
+        /// once an earlier match is known.
+        /// </summary>
+        constexpr static std::size_t parallel_block_size = 1 << 20;
+
        private:
+        /// <summary>
+        /// The state prepared from a pattern before scanning.
+        /// </summary>
+        struct context_t
+        {
+            /// <summary>
+            /// The pattern to scan for.
+            /// </summary>
+            pattern_t pattern;
+
+            /// <summary>
+            /// The bad character shifts of the Horspool family (bmh_t, tbm_t and raita_t). Empty for the other algorithms.
+            /// </summary>
+            std::array< std::size_t, 256 > skip_table{};
+
+            /// <summary>
+            /// The good suffix shifts of tbm_t, indexed by the position of the mismatch. Empty for the other algorithms.
+            /// </summary>
+            std::vector< std::size_t > suffix_table;
+        };
+
+        /// <summary>
+        /// Gets the number of shards a parallel search splits a buffer into.
+        /// </summary>
+        /// <param name="size">The size of the buffer.</param>
+        /// <param name="threads">The maximum number of threads. Zero uses one per hardware thread.</param>
+        /// <returns>At least one, and never more shards than there are whole blocks.</returns>
+        static std::size_t shard_count( std::size_t size, std::size_t threads ) noexcept;
+
+        /// <summary>
+        /// Builds the bad character table for the pattern of the context. Wildcards limit every shift, since they align with any byte.
+        /// </summary>
+        /// <param name="context">The context to fill.</param>
+        static void build_skip_table( context_t& context ) noexcept;
+
+        /// <summary>
+        /// Builds the good suffix table for the pattern of the context. A shift is only ruled out by fixed bytes that are known to disagree.
+        /// </summary>
+        /// <param name="context">The context to fill.</param>
+        static void build_suffix_table( context_t& context );
+
+        /// <summary>
+        /// Find the index of the compile time signature in the buffer. Candidates are located by jumping between occurrences of the anchor byte.
+        /// </summary>
+        /// <param name="span">The buffer to scan.</param>
+        /// <returns>A value greater than or equal to zero if success.</returns>
+        template< fixed_string_t S >
+        static std::int64_t index_of_signature( const std::span< std::uint8_t >& span ) noexcept;
+
         /// <summary>
         /// Find the index of the pattern in the buffer.
         /// </summary>
         /// <typeparam name="algorithm">The algorithm to use for scanning.</typeparam>
-        /// <param name="pattern">The pattern to scan for.</param>
-        /// <param name="data">The buffer to scan.</param>
-        /// <param name="size">The size of the buffer in bytes.</param>
+        /// <param name="context">The prepared pattern to scan for.</param>
+        /// <param name="span">The buffer to scan.</param>
         /// <returns>A value greater than or equal to zero if success.</returns>
         template< algorithm_t algorithm >
-        static std::int64_t index_of( const pattern_t& pattern, const std::span< std::uint8_t >& span ) noexcept;
+        static std::int64_t index_of( const context_t& context, const std::span< std::uint8_t >& span ) noexcept;
     };
 
     enum class scanner::algorithm_t
@@ -74,41 +181,109 @@ namespace wincpp::patterns
         /// <summary>
         /// The Turo-BM alogithm for scanning.
         /// </summary>
-        tbm_t
+        tbm_t,
+
+        /// <summary>
+        /// Vectorized scanning. Candidates are filtered on one or two anchor bytes, then verified with masked vector compares. AVX2, SSE4.2 or a
+        /// scalar fallback is picked at runtime.
+        /// </summary>
+        simd_t
     };
 
     /// <summary>
     /// The naive algorithm for scanning.
     /// </summary>
     template<>
-    static std::int64_t scanner::index_of< scanner::algorithm_t::naive_t >(
-        const pattern_t& pattern,
-        const std::span< std::uint8_t >& bytes ) noexcept;
+    std::int64_t scanner::index_of< scanner::algorithm_t::naive_t >( const context_t& context, const std::span< std::uint8_t >& bytes ) noexcept;
 
     /// <summary>
     /// The Boyer-Moore-Horspool algorithm for scanning.
     /// </summary>
     template<>
-    static std::int64_t scanner::index_of< scanner::algorithm_t::bmh_t >( const pattern_t& pattern, const std::span< std::uint8_t >& bytes ) noexcept;
+    std::int64_t scanner::index_of< scanner::algorithm_t::bmh_t >( const context_t& context, const std::span< std::uint8_t >& bytes ) noexcept;
 
     /// <summary>
     /// The Turbo-BM algorithm for scanning.
     /// </summary>
     template<>
-    static std::int64_t scanner::index_of< scanner::algorithm_t::tbm_t >( const pattern_t& pattern, const std::span< std::uint8_t >& bytes ) noexcept;
+    std::int64_t scanner::index_of< scanner::algorithm_t::tbm_t >( const context_t& context, const std::span< std::uint8_t >& bytes ) noexcept;
 
     /// <summary>
     /// The Raita algorithm for scanning.
     /// </summary>
     template<>
-    static std::int64_t scanner::index_of< scanner::algorithm_t::raita_t >(
-        const pattern_t& pattern,
-        const std::span< std::uint8_t >& bytes ) noexcept;
+    std::int64_t scanner::index_of< scanner::algorithm_t::raita_t >( const context_t& context, const std::span< std::uint8_t >& bytes ) noexcept;
+
+    /// <summary>
+    /// The vectorized algorithm for scanning.
+    /// </summary>
+    template<>
+    std::int64_t scanner::index_of< scanner::algorithm_t::simd_t >( const context_t& context, const std::span< std::uint8_t >& bytes ) noexcept;
 
     template< scanner::algorithm_t algorithm >
-    std::optional< std::uintptr_t > scanner::find( std::span< std::uint8_t > buffer, const pattern_t& pattern ) noexcept
+    class scanner::compiled final
+    {
+       public:
+        /// <summary>
+        /// Prepares the pattern for scanning.
+        /// </summary>
+        /// <param name="pattern">The pattern to search for.</param>
+        explicit compiled( const pattern_t& pattern ) noexcept;
+
+        /// <summary>
+        /// Searches for the pattern in the buffer.
+        /// </summary>
+        /// <param name="buffer">The buffer to search in.</param>
+        /// <returns>The relative location.</returns>
+        std::optional< std::uintptr_t > find( std::span< std::uint8_t > buffer ) const noexcept;
+
+        /// <summary>
+        /// Searches for all occurrences of the pattern in the buffer.
+        /// </summary>
+        /// <param name="buffer">The buffer to search in.</param>
+        /// <returns>The relative locations.</returns>
+        std::vector< std::uintptr_t > find_all( std::span< std::uint8_t > buffer ) const noexcept;
+
+        /// <summary>
+        /// Searches for the pattern in the buffer, split into shards that are scanned on separate threads. Shards overlap by the size of the
+        /// pattern minus one, and stop as soon as a match before them is known.
+        /// </summary>
+        /// <param name="buffer">The buffer to search in.</param>
+        /// <param name="threads">The maximum number of threads. Zero uses one per hardware thread.</param>
+        /// <returns>The lowest relative location, the same as `find`.</returns>
+        std::optional< std::uintptr_t > find_parallel( std::span< std::uint8_t > buffer, std::size_t threads = 0 ) const;
+
+        /// <summary>
+        /// Searches for all occurrences of the pattern in the buffer, split into shards that are scanned on separate threads.
+        /// </summary>
+        /// <param name="buffer">The buffer to search in.</param>
+        /// <param name="threads">The maximum number of threads. Zero uses one per hardware thread.</param>
+        /// <returns>The relative locations in increasing order, the same as `find_all`.</returns>
+        std::vector< std::uintptr_t > find_all_parallel( std::span< std::uint8_t > buffer, std::size_t threads = 0 ) const;
+
+        /// <summary>
+        /// Gets the compiled pattern.
+        /// </summary>
+        const pattern_t& pattern() const noexcept;
+
+       private:
+        context_t context;
+    };
+
+    template< scanner::algorithm_t algorithm >
+    scanner::compiled< algorithm >::compiled( const pattern_t& pattern ) noexcept : context{ pattern }
+    {
+        if constexpr ( algorithm == algorithm_t::bmh_t || algorithm == algorithm_t::tbm_t || algorithm == algorithm_t::raita_t )
+            scanner::build_skip_table( context );
+
+        if constexpr ( algorithm == algorithm_t::tbm_t )
+            scanner::build_suffix_table( context );
+    }
+
+    template< scanner::algorithm_t algorithm >
+    std::optional< std::uintptr_t > scanner::compiled< algorithm >::find( std::span< std::uint8_t > buffer ) const noexcept
     {
-        const auto result = scanner::index_of< algorithm >( pattern, buffer );
+        const auto result = scanner::index_of< algorithm >( context, buffer );
 
         if ( result != -1 )
             return result;
@@ -116,23 +291,255 @@ namespace wincpp::patterns
         return std::nullopt;
     }
 
+    template< scanner::algorithm_t algorithm >
+    std::vector< std::uintptr_t > scanner::compiled< algorithm >::find_all( std::span< std::uint8_t > buffer ) const noexcept
+    {
+        std::vector< std::uintptr_t > results;
+
+        for ( std::size_t i = 0; i < buffer.size(); )
+        {
+            const auto result = scanner::index_of< algorithm >( context, buffer.subspan( i ) );
+
+            if ( result == -1 )
+                break;
+
+            results.push_back( i + result );
+            i += result + context.pattern.size();
+        }
+
+        return results;
+    }
+
+    template< scanner::algorithm_t algorithm >
+    std::optional< std::uintptr_t > scanner::compiled< algorithm >::find_parallel( std::span< std::uint8_t > buffer, std::size_t threads ) const
+    {
+        const auto shards = scanner::shard_count( buffer.size(), threads );
+
+        if ( shards == 1 || context.pattern.size() == 0 )
+            return find( buffer );
+
+        const auto shard = ( buffer.size() + shards - 1 ) / shards;
+        const auto overlap = context.pattern.size() - 1;
+
+        std::atomic< std::size_t > best = std::numeric_limits< std::size_t >::max();
+
+        {
+            std::vector< std::jthread > workers;
+            workers.reserve( shards );
+
+            for ( std::size_t i = 0; i < shards; ++i )
+            {
+                workers.emplace_back(
+                    [ &, begin = i * shard ]
+                    {
+                        const auto end = std::min< std::size_t >( begin + shard, buffer.size() );
+
+                        // Blocks are scanned in order, so once a match before the current block is known nothing here can be lower.
+                        for ( auto block = begin; block < end && block < best.load( std::memory_order_relaxed ); block += parallel_block_size )
+                        {
+                            const auto stop = std::min< std::size_t >( block + parallel_block_size, end );
+                            const auto length = std::min< std::size_t >( stop + overlap, buffer.size() ) - block;
+                            const auto result = scanner::index_of< algorithm >( context, buffer.subspan( block, length ) );
+
+                            if ( result == -1 )
+                                continue;
+
+                            const auto found = block + static_cast< std::size_t >( result );
+                            auto current = best.load( std::memory_order_relaxed );
+
+                            while ( found < current && !best.compare_exchange_weak( current, found, std::memory_order_relaxed ) )
+                                ;
+
+                            return;
+                        }
+                    } );
+            }
+        }
+
+        if ( best == std::numeric_limits< std::size_t >::max() )
+            return std::nullopt;
+
+        return best.load();
+    }
+
+    template< scanner::algorithm_t algorithm >
+    std::vector< std::uintptr_t > scanner::compiled< algorithm >::find_all_parallel( std::span< std::uint8_t > buffer, std::size_t threads ) const
+    {
+        const auto shards = scanner::shard_count( buffer.size(), threads );
+
+        if ( shards == 1 || context.pattern.size() == 0 )
+            return find_all( buffer );
+
+        const auto size = context.pattern.size();
+        const auto shard = ( buffer.size() + shards - 1 ) / shards;
+
+        // The matches of every shard, found as if the buffer started at the shard.
+        std::vector< std::vector< std::uintptr_t > > chains( shards );
+
+        {
+            std::vector< std::jthread > workers;
+            workers.reserve( shards );
+
+            for ( std::size_t i = 0; i < shards; ++i )
+            {
+                workers.emplace_back(
+                    [ &, i, begin = i * shard ]
+                    {
+                        const auto end = std::min< std::size_t >( begin + shard, buffer.size() );
+                        const auto length = std::min< std::size_t >( end + size - 1, buffer.size() ) - begin;
+
+                        chains[ i ] = find_all( buffer.subspan( begin, length ) );
+
+                        for ( auto& result : chains[ i ] )
+                            result += begin;
+                    } );
+            }
+        }
+
+        std::vector< std::uintptr_t > results;
+        std::size_t next = 0;
+
+        for ( std::size_t i = 0; i < shards; ++i )
+        {
+            const auto begin = i * shard;
+            const auto end = std::min< std::size_t >( begin + shard, buffer.size() );
+            const auto& chain = chains[ i ];
+
+            auto from = chain.cbegin();
+
+            // The last match of the previous shard may reach into this one, in which case the matches of this shard that overlap it don't count.
+            // The serial search is continued from there until it lands on a match of this shard, after which both agree.
+            while ( next > begin )
+            {
+                if ( next >= end )
+                {
+                    from = chain.cend();
+                    break;
+                }
+
+                const auto stop = std::min< std::size_t >( end + size - 1, buffer.size() );
+                const auto result = scanner::index_of< algorithm >( context, buffer.subspan( next, stop - next ) );
+
+                if ( result == -1 )
+                {
+                    from = chain.cend();
+                    break;
+                }
+
+                const auto match = next + static_cast< std::size_t >( result );
+                from = std::lower_bound( from, chain.cend(), match );
+
+                if ( from != chain.cend() && *from == match )
+                    break;
+
+                results.push_back( match );
+                next = match + size;
+            }
+
+            results.insert( results.end(), from, chain.cend() );
+
+            if ( !results.empty() )
+                next = results.back() + size;
+        }
+
+        return results;
+    }
+
+    template< scanner::algorithm_t algorithm >
+    const pattern_t& scanner::compiled< algorithm >::pattern() const noexcept
+    {
+        return context.pattern;
+    }
+
+    template< scanner::algorithm_t algorithm >
+    std::optional< std::uintptr_t > scanner::find( std::span< std::uint8_t > buffer, const pattern_t& pattern ) noexcept
+    {
+        return compiled< algorithm >( pattern ).find( buffer );
+    }
+
     template< scanner::algorithm_t algorithm >
     std::vector< std::uintptr_t > scanner::find_all( std::span< std::uint8_t > buffer, const pattern_t& pattern ) noexcept
+    {
+        return compiled< algorithm >( pattern ).find_all( buffer );
+    }
+
+    template< scanner::algorithm_t algorithm >
+    std::optional< std::uintptr_t > scanner::find_parallel( std::span< std::uint8_t > buffer, const pattern_t& pattern, std::size_t threads )
+    {
+        return compiled< algorithm >( pattern ).find_parallel( buffer, threads );
+    }
+
+    template< scanner::algorithm_t algorithm >
+    std::vector< std::uintptr_t > scanner::find_all_parallel( std::span< std::uint8_t > buffer, const pattern_t& pattern, std::size_t threads )
+    {
+        return compiled< algorithm >( pattern ).find_all_parallel( buffer, threads );
+    }
+
+    template< fixed_string_t S >
+    std::optional< std::uintptr_t > scanner::find( std::span< std::uint8_t > buffer, const signature_t< S >& signature ) noexcept
+    {
+        const auto result = scanner::index_of_signature< S >( buffer );
+
+        if ( result != -1 )
+            return result;
+
+        return std::nullopt;
+    }
+
+    template< fixed_string_t S >
+    std::vector< std::uintptr_t > scanner::find_all( std::span< std::uint8_t > buffer, const signature_t< S >& signature ) noexcept
     {
         std::vector< std::uintptr_t > results;
 
-        for ( auto i = 0; i < buffer.size(); )
+        for ( std::size_t i = 0; i < buffer.size(); )
         {
-            const auto result = scanner::index_of< algorithm >( pattern, buffer.subspan( i ) );
+            const auto result = scanner::index_of_signature< S >( buffer.subspan( i ) );
 
             if ( result == -1 )
                 break;
 
             results.push_back( i + result );
-            i += result + pattern.size;
+            i += result + signature.size;
         }
 
         return results;
     }
 
+    template< fixed_string_t S >
+    std::int64_t scanner::index_of_signature( const std::span< std::uint8_t >& buffer ) noexcept
+    {
+        using signature = signature_t< S >;
+
+        if ( buffer.size() < signature::size )
+            return -1;
+
+        // A signature made of wildcards matches at the very start.
+        if constexpr ( signature::fixed.empty() )
+        {
+            return 0;
+        }
+        else
+        {
+            const auto data = buffer.data();
+            const auto stop = buffer.size() - signature::size;
+
+            for ( std::size_t i = 0; i <= stop; ++i )
+            {
+                // Jump to the next occurrence of the anchor byte.
+                const auto hit = static_cast< const std::uint8_t* >(
+                    std::memchr( data + i + signature::anchor, signature::bytes[ signature::anchor ], stop - i + 1 ) );
+
+                if ( !hit )
+                    return -1;
+
+                i = hit - data - signature::anchor;
+
+                if ( signature::matches( data + i ) )
+                    return static_cast< std::int64_t >( i );
+            }
+
+            return -1;
+        }
+    }
+
 }  // namespace wincpp::patterns
\ No newline at end of file
@@ -0,0 +1,253 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <utility>
+
+#include "wincpp/patterns/pattern.hpp"
+
+namespace wincpp::patterns
+{
+    /// <summary>
+    /// A string literal that can be used as a template argument.
+    /// </summary>
+    /// <typeparam name="N">The size of the literal, including the null terminator.</typeparam>
+    template< std::size_t N >
+    struct fixed_string_t
+    {
+        /// <summary>
+        /// Creates a new fixed string from a string literal.
+        /// </summary>
+        /// <param name="str">The string literal.</param>
+        consteval fixed_string_t( const char ( &str )[ N ] ) noexcept
+        {
+            std::copy_n( str, N, value );
+        }
+
+        /// <summary>
+        /// Gets the string without the null terminator.
+        /// </summary>
+        constexpr std::string_view view() const noexcept
+        {
+            return std::string_view( value, N - 1 );
+        }
+
+        char value[ N ]{};
+    };
+
+    /// <summary>
+    /// An IDA-style signature that is parsed at compile time. Example: "48 8B 05 ?? ?? ?? ?? 48 85 C0".
+    /// </summary>
+    /// <remarks>
+    /// Bytes are pairs of hex digits, wildcards are written as `?` or `??` and every token is separated by spaces. The layout of the signature and
+    /// the anchor byte used to locate candidates are fixed at compile time, and a malformed signature fails to compile.
+    /// </remarks>
+    /// <typeparam name="S">The signature string.</typeparam>
+    template< fixed_string_t S >
+    struct signature_t final
+    {
+       private:
+        /// <summary>
+        /// The result of parsing the signature string. The arrays are sized for the worst case (one token per character).
+        /// </summary>
+        struct parsed_t
+        {
+            std::size_t size = 0;
+            bool valid = true;
+            std::array< std::uint8_t, sizeof( S.value ) > bytes{};
+            std::array< bool, sizeof( S.value ) > mask{};
+        };
+
+        /// <summary>
+        /// Converts a hex digit to its value, or returns -1 if it isn't one.
+        /// </summary>
+        static consteval int hex_digit( char c ) noexcept
+        {
+            if ( c >= '0' && c <= '9' )
+                return c - '0';
+
+            if ( c >= 'a' && c <= 'f' )
+                return c - 'a' + 10;
+
+            if ( c >= 'A' && c <= 'F' )
+                return c - 'A' + 10;
+
+            return -1;
+        }
+
+        /// <summary>
+        /// Parses the signature string.
+        /// </summary>
+        static consteval parsed_t parse() noexcept
+        {
+            parsed_t result{};
+            const auto str = S.view();
+
+            for ( std::size_t i = 0; i < str.size(); )
+            {
+                if ( str[ i ] == ' ' )
+                {
+                    ++i;
+                    continue;
+                }
+
+                // A token runs until the next space.
+                auto end = i;
+
+                while ( end < str.size() && str[ end ] != ' ' )
+                    ++end;
+
+                const auto token = str.substr( i, end - i );
+
+                if ( token == "?" || token == "??" )
+                {
+                    result.mask[ result.size++ ] = false;
+                }
+                else if ( token.size() == 2 && hex_digit( token[ 0 ] ) >= 0 && hex_digit( token[ 1 ] ) >= 0 )
+                {
+                    result.bytes[ result.size ] = static_cast< std::uint8_t >( hex_digit( token[ 0 ] ) << 4 | hex_digit( token[ 1 ] ) );
+                    result.mask[ result.size++ ] = true;
+                }
+                else
+                {
+                    result.valid = false;
+                }
+
+                i = end;
+            }
+
+            if ( result.size == 0 )
+                result.valid = false;
+
+            return result;
+        }
+
+        constexpr static parsed_t parsed = parse();
+
+        static_assert( parsed.valid, "malformed signature: expected hex bytes and ?/?? wildcards separated by spaces" );
+
+        /// <summary>
+        /// Ranks how common a byte is in x64 code (lower is rarer). Used to pick the anchor byte.
+        /// </summary>
+        static constexpr int commonness( std::uint8_t byte ) noexcept
+        {
+            switch ( byte )
+            {
+                case 0x00:
+                case 0xFF: return 3;
+                case 0x48:
+                case 0x8B:
+                case 0xCC: return 2;
+                case 0x89:
+                case 0x4C:
+                case 0x0F:
+                case 0x24:
+                case 0x44: return 1;
+                default: return 0;
+            }
+        }
+
+       public:
+        /// <summary>
+        /// The number of bytes in the signature.
+        /// </summary>
+        constexpr static std::size_t size = parsed.size;
+
+        /// <summary>
+        /// The bytes of the signature. Wildcards are zero.
+        /// </summary>
+        constexpr static std::array< std::uint8_t, size > bytes = []
+        {
+            std::array< std::uint8_t, size > result{};
+            std::copy_n( parsed.bytes.begin(), size, result.begin() );
+            return result;
+        }();
+
+        /// <summary>
+        /// The mask of the signature. True for fixed bytes, false for wildcards.
+        /// </summary>
+        constexpr static std::array< bool, size > mask = []
+        {
+            std::array< bool, size > result{};
+            std::copy_n( parsed.mask.begin(), size, result.begin() );
+            return result;
+        }();
+
+        /// <summary>
+        /// The indices of the fixed bytes.
+        /// </summary>
+        constexpr static auto fixed = []
+        {
+            std::array< std::size_t, std::count( mask.begin(), mask.end(), true ) > result{};
+
+            for ( std::size_t i = 0, j = 0; i < size; ++i )
+            {
+                if ( mask[ i ] )
+                    result[ j++ ] = i;
+            }
+
+            return result;
+        }();
+
+        /// <summary>
+        /// The index of the anchor byte: the rarest fixed byte, preferring later ones on ties. Zero if there are no fixed bytes.
+        /// </summary>
+        constexpr static std::size_t anchor = []
+        {
+            std::size_t result = 0;
+
+            for ( const auto i : fixed )
+            {
+                if ( commonness( bytes[ i ] ) <= commonness( bytes[ result ] ) || !mask[ result ] )
+                    result = i;
+            }
+
+            return result;
+        }();
+
+        /// <summary>
+        /// Determines whether the signature matches the bytes at the specified location. The comparison is unrolled over the fixed bytes only.
+        /// </summary>
+        /// <param name="data">The bytes to compare against. At least `size` bytes must be readable.</param>
+        /// <returns>True if every fixed byte matches.</returns>
+        static bool matches( const std::uint8_t* data ) noexcept
+        {
+            return [ data ]< std::size_t... I >( std::index_sequence< I... > )
+            {
+                return ( ( data[ fixed[ I ] ] == bytes[ fixed[ I ] ] ) && ... );
+            }( std::make_index_sequence< fixed.size() >() );
+        }
+
+        /// <summary>
+        /// Converts the signature to a runtime pattern.
+        /// </summary>
+        operator pattern_t() const noexcept
+        {
+            constexpr auto smask = []
+            {
+                std::array< char, size > result{};
+
+                for ( std::size_t i = 0; i < size; ++i )
+                    result[ i ] = mask[ i ] ? 'x' : '?';
+
+                return result;
+            }();
+
+            return pattern_t( reinterpret_cast< const char* >( bytes.data() ), std::string_view( smask.data(), size ) );
+        }
+    };
+
+    namespace literals
+    {
+        /// <summary>
+        /// Creates a compile time signature from an IDA-style string. Example: "48 8B 05 ?? ?? ?? ?? 48 85 C0"_sig.
+        /// </summary>
+        template< fixed_string_t S >
+        consteval signature_t< S > operator""_sig() noexcept
+        {
+            return {};
+        }
+    }  // namespace literals
+}  // namespace wincpp::patterns
\ No newline at end of file
@@ -0,0 +1,42 @@
+#include "wincpp/core/cpu.hpp"
+
+#if defined( WINCPP_X86 ) && defined( _MSC_VER )
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+namespace wincpp::core
+{
+    cpu_features_t::cpu_features_t() noexcept
+    {
+#if defined( WINCPP_X86 ) && defined( _MSC_VER )
+        int info[ 4 ]{};
+
+        __cpuid( info, 0 );
+        const auto max_leaf = info[ 0 ];
+
+        __cpuid( info, 1 );
+        sse42 = info[ 2 ] & ( 1 << 20 );
+
+        // AVX state has to be enabled by the operating system (OSXSAVE and XCR0 bits 1 and 2), not just supported by the processor.
+        const bool os_avx = ( info[ 2 ] & ( 1 << 27 ) ) && ( _xgetbv( 0 ) & 0x6 ) == 0x6;
+
+        if ( max_leaf >= 7 )
+        {
+            __cpuidex( info, 7, 0 );
+            avx2 = os_avx && ( info[ 1 ] & ( 1 << 5 ) );
+        }
+#elif defined( WINCPP_X86 )
+        __builtin_cpu_init();
+
+        sse42 = __builtin_cpu_supports( "sse4.2" );
+        avx2 = __builtin_cpu_supports( "avx2" );
+#endif
+    }
+
+    const cpu_features_t& cpu_features_t::get() noexcept
+    {
+        static cpu_features_t instance;
+        return instance;
+    }
+}  // namespace wincpp::core
\ No newline at end of file
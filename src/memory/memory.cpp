@@ -1,8 +1,33 @@
 #include "wincpp/memory/region.hpp"
+#include "wincpp/patterns/multi_scanner.hpp"
 #include "wincpp/patterns/scanner.hpp"
 
+#ifdef max
+#undef max
+#endif  // max
+
+#ifdef min
+#undef min
+#endif  // min
+
 namespace wincpp::memory
 {
+    namespace
+    {
+        /// <summary>
+        /// Gets the size of the longest pattern of the scanner (at least one).
+        /// </summary>
+        std::size_t longest_pattern( const patterns::multi_scanner &scanner ) noexcept
+        {
+            std::size_t longest = 1;
+
+            for ( const auto &pattern : scanner.patterns() )
+                longest = std::max( longest, pattern.size() );
+
+            return longest;
+        }
+    }  // namespace
+
     working_set_information_t::working_set_information_t( const PSAPI_WORKING_SET_EX_INFORMATION &info ) noexcept
         : virtual_address( reinterpret_cast< std::uintptr_t >( info.VirtualAddress ) ),
           valid( info.VirtualAttributes.Valid ),
@@ -35,40 +60,97 @@ namespace wincpp::memory
                !region.protection().has( memory::protection_t::noaccess_t ) && !region.protection().has( memory::protection_t::guard_t );
     }
 
-    std::optional< std::uintptr_t > memory_t::find( const patterns::pattern_t &pattern ) const noexcept
+    void memory_t::scan_regions( std::size_t overlap, const chunk_callback &callback ) const noexcept
     {
         for ( const auto &region : regions() )
         {
             if ( !is_valid_region( region ) )
                 break;
 
-            const auto buffer = factory.read( region.address(), region.size() );
+            const auto size = region.size();
+
+            // The number of offsets each chunk is responsible for. The chunk itself also reads the `overlap` bytes that follow.
+            const auto window = scan_budget == 0 ? size : std::max( scan_budget, overlap + 1 ) - overlap;
+
+            for ( std::size_t offset = 0; offset < size; offset += window )
+            {
+                const auto length = std::min( size - offset, window + overlap );
+                const auto last = offset + length >= size;
 
-            std::span< std::uint8_t > bytes( buffer.get(), region.size() );
+                const auto buffer = factory.read( region.address() + offset, length );
 
-            if ( const auto result = patterns::scanner::find< patterns::scanner::algorithm_t::bmh_t >( bytes, pattern ) )
-                return region.address() + *result;
+                std::span< std::uint8_t > bytes( buffer.get(), length );
+
+                if ( !callback( region.address() + offset, bytes, last ? length : window ) )
+                    return;
+
+                if ( last )
+                    break;
+            }
         }
+    }
 
-        return std::nullopt;
+    std::optional< std::uintptr_t > memory_t::find( const patterns::pattern_t &pattern ) const noexcept
+    {
+        return find( patterns::scanner::compiled< patterns::scanner::algorithm_t::bmh_t >( pattern ) );
     }
 
     std::vector< std::uintptr_t > memory_t::find_all( const patterns::pattern_t &pattern ) const noexcept
     {
-        std::vector< std::uintptr_t > results;
-
-        for ( const auto &region : regions() )
-        {
-            if ( !is_valid_region( region ) )
-                break;
+        return find_all( patterns::scanner::compiled< patterns::scanner::algorithm_t::bmh_t >( pattern ) );
+    }
 
-            const auto buffer = factory.read( region.address(), region.size() );
+    std::vector< std::optional< std::uintptr_t > > memory_t::find( const patterns::multi_scanner &scanner ) const noexcept
+    {
+        std::vector< std::optional< std::uintptr_t > > results( scanner.size() );
+        std::size_t remaining = scanner.size();
+
+        scan_regions(
+            longest_pattern( scanner ) - 1,
+            [ & ]( std::uintptr_t address, std::span< std::uint8_t > bytes, std::size_t )
+            {
+                const auto found = scanner.find( bytes );
+
+                for ( std::size_t i = 0; i < results.size(); ++i )
+                {
+                    if ( !results[ i ] && found[ i ] )
+                    {
+                        results[ i ] = address + *found[ i ];
+                        --remaining;
+                    }
+                }
+
+                return remaining != 0;
+            } );
 
-            std::span< std::uint8_t > bytes( buffer.get(), region.size() );
+        return results;
+    }
 
-            for ( const auto &result : patterns::scanner::find_all< patterns::scanner::algorithm_t::bmh_t >( bytes, pattern ) )
-                results.push_back( region.address() + result );
-        }
+    std::vector< std::vector< std::uintptr_t > > memory_t::find_all( const patterns::multi_scanner &scanner ) const noexcept
+    {
+        std::vector< std::vector< std::uintptr_t > > results( scanner.size() );
+        std::vector< std::uintptr_t > next( scanner.size(), 0 );
+
+        scan_regions(
+            longest_pattern( scanner ) - 1,
+            [ & ]( std::uintptr_t address, std::span< std::uint8_t > bytes, std::size_t window )
+            {
+                // Every occurrence is reported, so the non-overlapping selection is made here across chunk boundaries.
+                scanner.find_each(
+                    bytes,
+                    [ & ]( std::size_t index, std::uintptr_t offset )
+                    {
+                        if ( offset < window && address + offset >= next[ index ] )
+                        {
+                            results[ index ].push_back( address + offset );
+                            next[ index ] = address + offset + scanner.patterns()[ index ].size();
+                        }
+
+                        return true;
+                    } );
+
+                return true;
+            } );
 
         return results;
     }
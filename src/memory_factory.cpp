@@ -115,6 +115,9 @@ namespace wincpp
         std::atomic< std::uintptr_t > address = 0;
         std::stop_source stop_source;
 
+        // The skip table is built once and shared by every region.
+        const patterns::scanner::compiled< patterns::scanner::algorithm_t::tbm_t > vtable( object->vtable() );
+
         const auto lambda = [ & ]( const memory::region_t& region )
         {
             if ( stop_source.stop_requested() )
@@ -125,7 +128,7 @@ namespace wincpp
                 return;
 
             std::span< std::uint8_t > bytes( buffer.get(), region.size() );
-            const auto result = patterns::scanner::find< patterns::scanner::algorithm_t::tbm_t >( bytes, object->vtable() );
+            const auto result = vtable.find( bytes );
 
             if ( result )
             {
@@ -0,0 +1,232 @@
+#include "wincpp/patterns/multi_scanner.hpp"
+
+#include <array>
+#include <limits>
+#include <queue>
+
+namespace wincpp::patterns
+{
+    multi_scanner::multi_scanner( std::span< const pattern_t > patterns ) : compiled( patterns.begin(), patterns.end() )
+    {
+        constexpr auto missing = std::numeric_limits< std::uint32_t >::max();
+
+        // The trie is built with missing edges first, they are filled in once the failure links are known.
+        std::vector< std::array< std::uint32_t, 256 > > trie( 1 );
+        std::vector< std::vector< std::uint32_t > > trie_outputs( 1 );
+
+        trie[ 0 ].fill( missing );
+
+        for ( std::uint32_t i = 0; i < compiled.size(); ++i )
+        {
+            const auto& pattern = compiled[ i ];
+
+            // Locate the longest run of fixed bytes.
+            std::size_t best_start = 0, best_length = 0;
+
+            for ( std::size_t j = 0; j < pattern.size(); )
+            {
+                if ( !pattern.fixed( j ) )
+                {
+                    ++j;
+                    continue;
+                }
+
+                const auto start = j;
+
+                while ( j < pattern.size() && pattern.fixed( j ) )
+                    ++j;
+
+                if ( j - start > best_length )
+                {
+                    best_start = start;
+                    best_length = j - start;
+                }
+            }
+
+            if ( best_length == 0 )
+            {
+                if ( pattern.size() != 0 )
+                    unanchored.push_back( i );
+
+                continue;
+            }
+
+            best_length = std::min( best_length, max_keyword );
+
+            // Insert the run into the trie.
+            std::uint32_t state = 0;
+
+            for ( std::size_t j = best_start; j < best_start + best_length; ++j )
+            {
+                auto& next = trie[ state ][ pattern.bytes()[ j ] ];
+
+                if ( next == missing )
+                {
+                    next = static_cast< std::uint32_t >( trie.size() );
+
+                    trie.emplace_back().fill( missing );
+                    trie_outputs.emplace_back();
+                }
+
+                state = trie[ state ][ pattern.bytes()[ j ] ];
+            }
+
+            trie_outputs[ state ].push_back( static_cast< std::uint32_t >( keywords.size() ) );
+            keywords.push_back( { i, static_cast< std::uint32_t >( best_start + best_length - 1 ) } );
+        }
+
+        // Compute the failure links breadth first, turning the trie into a complete automaton. A state's failure link is always shallower, so its
+        // outputs are final by the time they are merged.
+        std::vector< std::uint32_t > failure( trie.size(), 0 );
+        std::queue< std::uint32_t > queue;
+
+        for ( auto& next : trie[ 0 ] )
+        {
+            if ( next == missing )
+                next = 0;
+            else
+                queue.push( next );
+        }
+
+        while ( !queue.empty() )
+        {
+            const auto state = queue.front();
+            queue.pop();
+
+            for ( std::size_t byte = 0; byte < 256; ++byte )
+            {
+                auto& next = trie[ state ][ byte ];
+
+                if ( next == missing )
+                {
+                    next = trie[ failure[ state ] ][ byte ];
+                    continue;
+                }
+
+                failure[ next ] = trie[ failure[ state ] ][ byte ];
+
+                const auto& inherited = trie_outputs[ failure[ next ] ];
+                trie_outputs[ next ].insert( trie_outputs[ next ].end(), inherited.begin(), inherited.end() );
+
+                queue.push( next );
+            }
+        }
+
+        // Flatten the automaton.
+        transitions.reserve( trie.size() * 256 );
+        output_offsets.reserve( trie.size() + 1 );
+
+        for ( std::size_t state = 0; state < trie.size(); ++state )
+        {
+            transitions.insert( transitions.end(), trie[ state ].begin(), trie[ state ].end() );
+
+            output_offsets.push_back( static_cast< std::uint32_t >( outputs.size() ) );
+            outputs.insert( outputs.end(), trie_outputs[ state ].begin(), trie_outputs[ state ].end() );
+        }
+
+        output_offsets.push_back( static_cast< std::uint32_t >( outputs.size() ) );
+    }
+
+    template< typename Callback >
+    bool multi_scanner::scan( std::span< std::uint8_t > buffer, Callback&& callback ) const noexcept
+    {
+        const auto data = buffer.data();
+        const auto size = buffer.size();
+
+        // Patterns made of wildcards match at every position.
+        for ( const auto index : unanchored )
+        {
+            for ( std::size_t start = 0; start + compiled[ index ].size() <= size; ++start )
+            {
+                if ( !callback( index, start ) )
+                    return false;
+            }
+        }
+
+        std::uint32_t state = 0;
+
+        for ( std::size_t i = 0; i < size; ++i )
+        {
+            state = transitions[ state * 256 + data[ i ] ];
+
+            for ( auto j = output_offsets[ state ]; j < output_offsets[ state + 1 ]; ++j )
+            {
+                const auto& keyword = keywords[ outputs[ j ] ];
+                const auto& pattern = compiled[ keyword.pattern ];
+
+                // The keyword ends at `i`, so the pattern would start `keyword.end` bytes before it.
+                if ( i < keyword.end || i - keyword.end + pattern.size() > size )
+                    continue;
+
+                const auto start = i - keyword.end;
+
+                if ( pattern.matches( data + start ) && !callback( keyword.pattern, start ) )
+                    return false;
+            }
+        }
+
+        return true;
+    }
+
+    std::vector< std::optional< std::uintptr_t > > multi_scanner::find( std::span< std::uint8_t > buffer ) const noexcept
+    {
+        std::vector< std::optional< std::uintptr_t > > results( compiled.size() );
+        std::size_t remaining = keywords.size() + unanchored.size();
+
+        if ( remaining == 0 )
+            return results;
+
+        scan(
+            buffer,
+            [ & ]( std::uint32_t index, std::size_t start )
+            {
+                if ( !results[ index ] )
+                {
+                    results[ index ] = start;
+                    --remaining;
+                }
+
+                // Stop as soon as every pattern has been located.
+                return remaining != 0;
+            } );
+
+        return results;
+    }
+
+    std::vector< std::vector< std::uintptr_t > > multi_scanner::find_all( std::span< std::uint8_t > buffer ) const noexcept
+    {
+        std::vector< std::vector< std::uintptr_t > > results( compiled.size() );
+        std::vector< std::size_t > next( compiled.size(), 0 );
+
+        scan(
+            buffer,
+            [ & ]( std::uint32_t index, std::size_t start )
+            {
+                // Skip occurrences overlapping the previous one, the same way `scanner::find_all` does.
+                if ( start >= next[ index ] )
+                {
+                    results[ index ].push_back( start );
+                    next[ index ] = start + compiled[ index ].size();
+                }
+
+                return true;
+            } );
+
+        return results;
+    }
+
+    void multi_scanner::find_each( std::span< std::uint8_t > buffer, const std::function< bool( std::size_t, std::uintptr_t ) >& callback ) const noexcept
+    {
+        scan( buffer, [ & ]( std::uint32_t index, std::size_t start ) { return callback( index, start ); } );
+    }
+
+    const std::vector< pattern_t >& multi_scanner::patterns() const noexcept
+    {
+        return compiled;
+    }
+
+    std::size_t multi_scanner::size() const noexcept
+    {
+        return compiled.size();
+    }
+}  // namespace wincpp::patterns
\ No newline at end of file
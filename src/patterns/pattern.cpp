@@ -1,39 +1,131 @@
 #include "wincpp/patterns/pattern.hpp"
 
+#include <bit>
 #include <sstream>
 #include <string_view>
 #include <vector>
 
 namespace wincpp::patterns
 {
-    pattern_t::pattern_t( const char* const aob, const std::string_view smask ) noexcept : size( smask.size() )
+    namespace
     {
-        bytes = std::shared_ptr< std::uint8_t[] >( new std::uint8_t[ size ] );
-        mask = std::shared_ptr< bool[] >( new bool[ size ] );
+        /// <summary>
+        /// Returns a bit for every non-zero byte of the word (bit `i` for byte `i`).
+        /// </summary>
+        std::uint8_t nonzero_bytes( std::uint64_t word ) noexcept
+        {
+            constexpr std::uint64_t low = 0x7F7F7F7F7F7F7F7F;
+
+            // Sets the high bit of every non-zero byte without carrying into the next one.
+            const auto high = ( ( ( word & low ) + low ) | word ) & ~low;
+
+            // Gathers the high bits into the top byte.
+            return static_cast< std::uint8_t >( ( ( high >> 7 ) * 0x0102040810204080 ) >> 56 );
+        }
+    }  // namespace
+
+    pattern_t::pattern_t( const char* const aob, const std::string_view smask ) noexcept
+    {
+        allocate( smask.size() );
+
+        const auto bytes = mutable_bytes();
+        const auto mask = mutable_mask();
 
-        for ( std::size_t i = 0; i < size; ++i )
+        for ( std::size_t i = 0; i < length; ++i )
         {
-            bytes[ i ] = aob[ i ];
-            mask[ i ] = smask[ i ] == 'x';
+            if ( smask[ i ] == 'x' )
+            {
+                bytes[ i ] = aob[ i ];
+                mask[ i / 64 ] |= std::uint64_t( 1 ) << ( i % 64 );
+            }
         }
+
+        finalize();
+    }
+
+    void pattern_t::allocate( std::size_t size ) noexcept
+    {
+        length = size;
+        inline_mask = 0;
+        std::memset( inline_bytes, 0, sizeof( inline_bytes ) );
+
+        if ( size > inline_capacity )
+            heap = std::shared_ptr< std::uint64_t[] >( new std::uint64_t[ mask_words( size ) + ( size + 7 ) / 8 ]() );
+        else
+            heap.reset();
+    }
+
+    void pattern_t::finalize() noexcept
+    {
+        const auto words = mask();
+
+        std::size_t fixed_count = 0;
+        first = last = length;
+
+        for ( std::size_t i = 0; i < mask_words( length ); ++i )
+        {
+            if ( !words[ i ] )
+                continue;
+
+            fixed_count += std::popcount( words[ i ] );
+
+            if ( first == length )
+                first = i * 64 + std::countr_zero( words[ i ] );
+
+            last = i * 64 + 63 - std::countl_zero( words[ i ] );
+        }
+
+        wildcard_count = length - fixed_count;
+    }
+
+    bool pattern_t::matches( const std::uint8_t* data ) const noexcept
+    {
+        const auto pattern = bytes();
+        const auto words = mask();
+
+        std::size_t i = 0;
+
+        // Compare eight bytes at a time and keep only the differences that fall on fixed bytes.
+        for ( ; i + 8 <= length; i += 8 )
+        {
+            const auto fixed_bits = static_cast< std::uint8_t >( words[ i / 64 ] >> ( i % 64 ) );
+
+            if ( !fixed_bits )
+                continue;
+
+            std::uint64_t lhs, rhs;
+            std::memcpy( &lhs, data + i, sizeof( lhs ) );
+            std::memcpy( &rhs, pattern + i, sizeof( rhs ) );
+
+            if ( nonzero_bytes( lhs ^ rhs ) & fixed_bits )
+                return false;
+        }
+
+        for ( ; i < length; ++i )
+        {
+            if ( fixed( i ) && pattern[ i ] != data[ i ] )
+                return false;
+        }
+
+        return true;
     }
 
     std::string pattern_t::to_string() const noexcept
     {
         std::stringstream ss;
 
-        for ( std::size_t i = 0; i < size; ++i )
+        for ( std::size_t i = 0; i < length; ++i )
         {
-            if ( mask[ i ] )
+            if ( fixed( i ) )
             {
-                ss << std::hex << static_cast< int >( bytes[ i ] );
+                ss << std::hex << static_cast< int >( bytes()[ i ] );
             }
             else
             {
                 ss << "?";
             }
 
-            if ( i + 1 < size )
+            if ( i + 1 < length )
             {
                 ss << " ";
             }
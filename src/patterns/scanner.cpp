@@ -1,119 +1,356 @@
 #include "wincpp/patterns/scanner.hpp"
 
-#include "wincpp/memory/memory.hpp"
+#include <bit>
+
+#include "wincpp/core/cpu.hpp"
+
+#if defined( WINCPP_X86 )
+#include <immintrin.h>
+#endif
 
 #undef max
 #undef min
 
 namespace wincpp::patterns
 {
-    template<>
-    static std::int64_t scanner::index_of< scanner::algorithm_t::naive_t >(
-        const pattern_t& pattern,
-        const std::span< std::uint8_t >& buffer ) noexcept
+    namespace
     {
-        for ( auto it = buffer.cbegin(); it != buffer.cend(); ++it )
+        /// <summary>
+        /// The fixed bytes used to filter candidates before the full pattern is compared.
+        /// </summary>
+        struct anchors_t
+        {
+            std::size_t first_idx, last_idx;
+            std::uint8_t first, last;
+        };
+
+        /// <summary>
+        /// Picks the first and last fixed bytes of the pattern as anchors.
+        /// </summary>
+        /// <returns>False if the pattern consists only of wildcards.</returns>
+        bool select_anchors( const pattern_t& pattern, anchors_t& anchors ) noexcept
+        {
+            const auto first = pattern.first_fixed(), last = pattern.last_fixed();
+
+            if ( first == pattern.size() )
+                return false;
+
+            anchors = { first, last, pattern.bytes()[ first ], pattern.bytes()[ last ] };
+            return true;
+        }
+
+        /// <summary>
+        /// Compares the pattern against the bytes at `data`, starting at pattern index `from`.
+        /// </summary>
+        bool verify_scalar( const pattern_t& pattern, const std::uint8_t* data, std::size_t from ) noexcept
         {
-            for ( auto i = 0; i < pattern.size; ++i )
+            for ( std::size_t i = from; i < pattern.size(); ++i )
             {
-                if ( pattern.mask[ i ] && pattern.bytes[ i ] != it[ i ] )
-                    break;
+                if ( pattern.fixed( i ) && pattern.bytes()[ i ] != data[ i ] )
+                    return false;
+            }
+
+            return true;
+        }
 
-                if ( i == pattern.size - 1 )
-                    return static_cast< std::int64_t >( it - buffer.cbegin() );
+        /// <summary>
+        /// Scalar scan over the start positions [start, stop] using the anchors as a filter.
+        /// </summary>
+        std::int64_t scan_scalar(
+            const pattern_t& pattern,
+            const anchors_t& anchors,
+            const std::uint8_t* data,
+            std::size_t start,
+            std::size_t stop ) noexcept
+        {
+            for ( std::size_t i = start; i <= stop; ++i )
+            {
+                if ( data[ i + anchors.first_idx ] == anchors.first && data[ i + anchors.last_idx ] == anchors.last &&
+                     pattern.matches( data + i ) )
+                    return static_cast< std::int64_t >( i );
             }
+
+            return -1;
         }
 
-        return -1;
-    }
+#if defined( WINCPP_X86 )
+        /// <summary>
+        /// Gets the bits of the packed mask for the pattern bytes [index, index + count). `index` has to be a multiple of `count`.
+        /// </summary>
+        std::uint32_t mask_bits( const pattern_t& pattern, std::size_t index, std::size_t count ) noexcept
+        {
+            const auto word = pattern.mask()[ index / 64 ] >> ( index % 64 );
+            return static_cast< std::uint32_t >( word & ( ( std::uint64_t( 1 ) << count ) - 1 ) );
+        }
 
-    template<>
-    static std::int64_t scanner::index_of< scanner::algorithm_t::bmh_t >( const pattern_t& pattern, const std::span< std::uint8_t >& buffer ) noexcept
-    {
-        if ( pattern.size == 0 || buffer.size() == 0 || pattern.size > buffer.size() )
+        /// <summary>
+        /// Masked compare of the pattern in 16 byte blocks. The equality bits of each block are tested against the packed mask.
+        /// </summary>
+        WINCPP_TARGET( "sse4.2" ) bool verify_sse42( const pattern_t& pattern, const std::uint8_t* data, std::size_t from ) noexcept
         {
-            return -1;
+            const auto bytes = pattern.bytes();
+
+            std::size_t i = from;
+
+            for ( ; i + 16 <= pattern.size(); i += 16 )
+            {
+                const auto equal = _mm_movemask_epi8( _mm_cmpeq_epi8(
+                    _mm_loadu_si128( reinterpret_cast< const __m128i* >( data + i ) ),
+                    _mm_loadu_si128( reinterpret_cast< const __m128i* >( bytes + i ) ) ) );
+
+                if ( mask_bits( pattern, i, 16 ) & ~static_cast< std::uint32_t >( equal ) )
+                    return false;
+            }
+
+            return verify_scalar( pattern, data, i );
+        }
+
+        WINCPP_TARGET( "sse4.2" )
+        std::int64_t scan_sse42( const pattern_t& pattern, const anchors_t& anchors, const std::uint8_t* data, std::size_t stop ) noexcept
+        {
+            const auto first = _mm_set1_epi8( static_cast< char >( anchors.first ) );
+            const auto last = _mm_set1_epi8( static_cast< char >( anchors.last ) );
+
+            std::size_t i = 0;
+
+            // Each block tests 16 consecutive start positions. The loads at `i + last_idx` stay within the buffer as long as `i + 15 <= stop`.
+            for ( ; i + 15 <= stop; i += 16 )
+            {
+                const auto a = _mm_cmpeq_epi8( _mm_loadu_si128( reinterpret_cast< const __m128i* >( data + i + anchors.first_idx ) ), first );
+                const auto b = _mm_cmpeq_epi8( _mm_loadu_si128( reinterpret_cast< const __m128i* >( data + i + anchors.last_idx ) ), last );
+
+                for ( auto bits = static_cast< std::uint32_t >( _mm_movemask_epi8( _mm_and_si128( a, b ) ) ); bits; bits &= bits - 1 )
+                {
+                    const auto candidate = i + std::countr_zero( bits );
+
+                    if ( verify_sse42( pattern, data + candidate, 0 ) )
+                        return static_cast< std::int64_t >( candidate );
+                }
+            }
+
+            return scan_scalar( pattern, anchors, data, i, stop );
         }
 
-        // Build the skip table for the Boyer-Moore-Horspool algorithm
-        std::size_t skip_table[ 256 ];  // Assume byte values range from 0 to 255
+        /// <summary>
+        /// Masked compare of the pattern in 32 byte blocks, the remainder is handed to the SSE4.2 compare.
+        /// </summary>
+        WINCPP_TARGET( "avx2" ) bool verify_avx2( const pattern_t& pattern, const std::uint8_t* data ) noexcept
+        {
+            const auto bytes = pattern.bytes();
+
+            std::size_t i = 0;
 
-        std::fill( std::begin( skip_table ), std::end( skip_table ), pattern.size );
+            for ( ; i + 32 <= pattern.size(); i += 32 )
+            {
+                const auto equal = _mm256_movemask_epi8( _mm256_cmpeq_epi8(
+                    _mm256_loadu_si256( reinterpret_cast< const __m256i* >( data + i ) ),
+                    _mm256_loadu_si256( reinterpret_cast< const __m256i* >( bytes + i ) ) ) );
+
+                if ( mask_bits( pattern, i, 32 ) & ~static_cast< std::uint32_t >( equal ) )
+                    return false;
+            }
+
+            return verify_sse42( pattern, data, i );
+        }
 
-        for ( std::size_t i = 0; i < pattern.size - 1; ++i )
+        WINCPP_TARGET( "avx2" )
+        std::int64_t scan_avx2( const pattern_t& pattern, const anchors_t& anchors, const std::uint8_t* data, std::size_t stop ) noexcept
         {
-            if ( pattern.mask[ i ] )
+            const auto first = _mm256_set1_epi8( static_cast< char >( anchors.first ) );
+            const auto last = _mm256_set1_epi8( static_cast< char >( anchors.last ) );
+
+            std::size_t i = 0;
+
+            for ( ; i + 31 <= stop; i += 32 )
             {
-                // Only build the table for strict bytes
-                skip_table[ pattern.bytes[ i ] ] = pattern.size - 1 - i;
+                const auto a = _mm256_cmpeq_epi8( _mm256_loadu_si256( reinterpret_cast< const __m256i* >( data + i + anchors.first_idx ) ), first );
+                const auto b = _mm256_cmpeq_epi8( _mm256_loadu_si256( reinterpret_cast< const __m256i* >( data + i + anchors.last_idx ) ), last );
+
+                for ( auto bits = static_cast< std::uint32_t >( _mm256_movemask_epi8( _mm256_and_si256( a, b ) ) ); bits; bits &= bits - 1 )
+                {
+                    const auto candidate = i + std::countr_zero( bits );
+
+                    if ( verify_avx2( pattern, data + candidate ) )
+                        return static_cast< std::int64_t >( candidate );
+                }
             }
+
+            return scan_scalar( pattern, anchors, data, i, stop );
         }
+#endif
+    }  // namespace
 
-        // Perform the search
-        std::int64_t buffer_idx = 0;
+    std::size_t scanner::shard_count( std::size_t size, std::size_t threads ) noexcept
+    {
+        if ( threads == 0 )
+            threads = std::max( 1u, std::thread::hardware_concurrency() );
 
-        while ( buffer_idx <= static_cast< std::int64_t >( buffer.size() - pattern.size ) )
+        return std::clamp< std::size_t >( size / parallel_block_size, 1, threads );
+    }
+
+    void scanner::build_skip_table( context_t& context ) noexcept
+    {
+        const auto& pattern = context.pattern;
+
+        if ( pattern.size() == 0 )
+            return;
+
+        const auto last_idx = pattern.size() - 1;
+
+        // A wildcard aligns with any byte, so no shift may move past the last one (the final position doesn't count, shifts are computed from
+        // the byte under it).
+        std::size_t wildcard = last_idx;
+
+        for ( std::size_t i = last_idx; i-- > 0; )
         {
-            std::int64_t pattern_idx = pattern.size - 1;
+            if ( !pattern.fixed( i ) )
+            {
+                wildcard = i;
+                break;
+            }
+        }
 
-            // Match from the end of the pattern
-            while ( pattern_idx >= 0 )
+        context.skip_table.fill( wildcard == last_idx ? pattern.size() : last_idx - wildcard );
+
+        for ( std::size_t i = wildcard == last_idx ? 0 : wildcard + 1; i < last_idx; ++i )
+        {
+            if ( pattern.fixed( i ) )
+                context.skip_table[ pattern.bytes()[ i ] ] = last_idx - i;
+        }
+    }
+
+    void scanner::build_suffix_table( context_t& context )
+    {
+        const auto& pattern = context.pattern;
+        const auto size = static_cast< std::int64_t >( pattern.size() );
+        const auto bytes = pattern.bytes();
+
+        // Zero marks positions that have no shift yet. A shift by the whole pattern is always possible.
+        context.suffix_table.assign( pattern.size(), 0 );
+
+        for ( std::int64_t shift = 1; shift <= size; ++shift )
+        {
+            // The rightmost position where the shifted pattern contradicts itself. Mismatches left of it can't use this shift.
+            auto conflict = std::int64_t( -1 );
+
+            for ( auto k = size - 1; k >= shift; --k )
             {
-                if ( pattern.mask[ pattern_idx ] && pattern.bytes[ pattern_idx ] != buffer[ buffer_idx + pattern_idx ] )
+                if ( pattern.fixed( k ) && pattern.fixed( k - shift ) && bytes[ k ] != bytes[ k - shift ] )
                 {
-                    break;  // Strict match failed, exit loop
+                    conflict = k;
+                    break;
                 }
-                --pattern_idx;
             }
 
-            if ( pattern_idx < 0 )
+            for ( auto i = std::max( conflict, std::int64_t( 0 ) ); i < size; ++i )
             {
-                return buffer_idx;  // Pattern found
+                if ( context.suffix_table[ i ] != 0 )
+                    continue;
+
+                // The byte under a mismatch differs from the pattern byte, so the shift is useless if it brings the same byte there again.
+                if ( i >= shift && pattern.fixed( i ) && pattern.fixed( i - shift ) && bytes[ i ] == bytes[ i - shift ] )
+                    continue;
+
+                context.suffix_table[ i ] = shift;
             }
+        }
+    }
 
-            // Use the skip table to jump forward
-            std::uint8_t last_byte = buffer[ buffer_idx + pattern.size - 1 ];
-            buffer_idx += skip_table[ last_byte ];
+    template<>
+    std::int64_t scanner::index_of< scanner::algorithm_t::naive_t >( const context_t& context, const std::span< std::uint8_t >& buffer ) noexcept
+    {
+        const auto& pattern = context.pattern;
+
+        if ( pattern.size() == 0 || pattern.size() > buffer.size() )
+        {
+            return -1;
         }
 
-        return -1;  // No match found
+        // Only start positions where the whole pattern still fits in the buffer.
+        for ( auto it = buffer.begin(); it != buffer.end() - pattern.size() + 1; ++it )
+        {
+            for ( auto i = 0; i < pattern.size(); ++i )
+            {
+                if ( pattern.fixed( i ) && pattern.bytes()[ i ] != it[ i ] )
+                    break;
+
+                if ( i == pattern.size() - 1 )
+                    return static_cast< std::int64_t >( it - buffer.begin() );
+            }
+        }
+
+        return -1;
     }
 
     template<>
-    static std::int64_t scanner::index_of< scanner::algorithm_t::tbm_t >( const pattern_t& pattern, const std::span< std::uint8_t >& buffer ) noexcept
+    std::int64_t scanner::index_of< scanner::algorithm_t::bmh_t >( const context_t& context, const std::span< std::uint8_t >& buffer ) noexcept
     {
-        if ( pattern.size == 0 || buffer.size() == 0 || pattern.size > buffer.size() )
+        const auto& pattern = context.pattern;
+
+        if ( pattern.size() == 0 || buffer.size() == 0 || pattern.size() > buffer.size() )
         {
             return -1;
         }
 
-        // Build the skip table for the Turbo Boyer-Moore algorithm
-        std::size_t skip_table[ 256 ];
-        std::fill( std::begin( skip_table ), std::end( skip_table ), pattern.size );
+        const auto& skip_table = context.skip_table;
+
+        // Perform the search
+        std::int64_t buffer_idx = 0;
 
-        for ( std::size_t i = 0; i < pattern.size - 1; ++i )
+        while ( buffer_idx <= static_cast< std::int64_t >( buffer.size() - pattern.size() ) )
         {
-            if ( pattern.mask[ i ] )
+            // Compare the whole window, eight bytes at a time against the packed mask
+            if ( pattern.matches( buffer.data() + buffer_idx ) )
             {
-                skip_table[ pattern.bytes[ i ] ] = pattern.size - 1 - i;
+                return buffer_idx;  // Pattern found
             }
+
+            // Use the skip table to jump forward
+            std::uint8_t last_byte = buffer[ buffer_idx + pattern.size() - 1 ];
+            buffer_idx += skip_table[ last_byte ];
         }
 
-        // Variables for turbo shift optimization
-        std::int64_t turbo_shift = 0;
-        std::int64_t shift = 0;
-        std::int64_t j = 0;  // j is the index in the buffer
+        return -1;  // No match found
+    }
+
+    template<>
+    std::int64_t scanner::index_of< scanner::algorithm_t::tbm_t >( const context_t& context, const std::span< std::uint8_t >& buffer ) noexcept
+    {
+        const auto& pattern = context.pattern;
+
+        if ( pattern.size() == 0 || buffer.size() == 0 || pattern.size() > buffer.size() )
+        {
+            return -1;
+        }
+
+        const auto bytes = pattern.bytes();
+
+        const auto& skip_table = context.skip_table;
+        const auto& suffix_table = context.suffix_table;
+
+        const auto size = static_cast< std::int64_t >( pattern.size() );
+        const auto end = static_cast< std::int64_t >( buffer.size() ) - size;
+
+        // The turbo shift and the skipped comparisons rely on the remembered factor of the text being equal to a factor of the pattern, which
+        // wildcards break. Patterns with wildcards fall back to the plain Boyer-Moore shifts.
+        const bool exact = pattern.wildcards() == 0;
+
+        std::int64_t j = 0;         // The index in the buffer
+        std::int64_t memory = 0;    // The length of the factor known to match from the previous attempt
+        std::int64_t shift = size;  // The previous shift
 
         // Perform the search
-        while ( j <= static_cast< std::int64_t >( buffer.size() - pattern.size ) )
+        while ( j <= end )
         {
-            // Match from the end of the pattern
-            std::int64_t i = pattern.size - 1;
+            std::int64_t i = size - 1;
 
-            // Compare the pattern from the end towards the beginning
-            while ( i >= 0 && pattern.bytes[ i ] == buffer[ j + i ] )
+            // Compare the pattern from the end towards the beginning, jumping over the remembered factor
+            while ( i >= 0 && ( !pattern.fixed( i ) || bytes[ i ] == buffer[ j + i ] ) )
             {
                 --i;
+
+                if ( memory != 0 && i == size - 1 - shift )
+                    i -= memory;
             }
 
             if ( i < 0 )
@@ -121,79 +358,64 @@ namespace wincpp::patterns
                 return j;  // Pattern found
             }
 
-            // Check if we can apply the turbo shift
-            if ( turbo_shift > 0 )
+            const auto matched = size - 1 - i;
+            const auto turbo_shift = memory - matched;
+            const auto bad_character_shift = static_cast< std::int64_t >( skip_table[ buffer[ j + i ] ] ) - matched;
+            const auto good_suffix_shift = static_cast< std::int64_t >( suffix_table[ i ] );
+
+            shift = std::max( { turbo_shift, bad_character_shift, good_suffix_shift } );
+
+            if ( shift == good_suffix_shift )
             {
-                shift = std::max( std::int64_t( 1 ), static_cast< std::int64_t >( skip_table[ buffer[ j + pattern.size - 1 ] ] ) );
-                turbo_shift = 0;  // Reset turbo shift after using it
+                memory = exact ? std::min( size - shift, matched ) : 0;
             }
             else
             {
-                // Otherwise, shift based on the skip table
-                std::uint8_t last_byte = buffer[ j + pattern.size - 1 ];
-                shift = skip_table[ last_byte ];
+                if ( turbo_shift < bad_character_shift )
+                    shift = std::max( shift, memory + 1 );
 
-                // Apply turbo shift if applicable
-                if ( i < pattern.size - 1 )
-                {
-                    turbo_shift = pattern.size - 1 - i;
-                }
+                memory = 0;
             }
 
-            j += std::max( shift, turbo_shift );  // Move forward by the calculated shift or turbo shift
+            j += shift;
         }
 
         return -1;  // No match found
     }
 
     template<>
-    static std::int64_t scanner::index_of< scanner::algorithm_t::raita_t >(
-        const pattern_t& pattern,
-        const std::span< std::uint8_t >& buffer ) noexcept
+    std::int64_t scanner::index_of< scanner::algorithm_t::raita_t >( const context_t& context, const std::span< std::uint8_t >& buffer ) noexcept
     {
-        if ( pattern.size == 0 || buffer.size() == 0 || pattern.size > buffer.size() )
+        const auto& pattern = context.pattern;
+
+        if ( pattern.size() == 0 || buffer.size() == 0 || pattern.size() > buffer.size() )
         {
             return -1;
         }
 
+        const auto bytes = pattern.bytes();
+
         // Raita uses a combination of the first, middle, and last bytes for an efficient search
-        std::size_t last_idx = pattern.size - 1;
-        std::size_t mid_idx = pattern.size / 2;
+        std::size_t last_idx = pattern.size() - 1;
+        std::size_t mid_idx = pattern.size() / 2;
 
-        // Build the skip table for the Raita algorithm
-        std::size_t skip_table[ 256 ];
-        std::fill( std::begin( skip_table ), std::end( skip_table ), pattern.size );
-
-        for ( std::size_t i = 0; i < last_idx; ++i )
-        {
-            if ( pattern.mask[ i ] )
-            {
-                skip_table[ pattern.bytes[ i ] ] = last_idx - i;
-            }
-        }
+        const auto& skip_table = context.skip_table;
 
         std::int64_t buffer_idx = 0;
 
-        while ( buffer_idx <= static_cast< std::int64_t >( buffer.size() - pattern.size ) )
+        while ( buffer_idx <= static_cast< std::int64_t >( buffer.size() - pattern.size() ) )
         {
             // Check the last byte first
-            if ( !pattern.mask[ last_idx ] || pattern.bytes[ last_idx ] == buffer[ buffer_idx + last_idx ] )
+            if ( !pattern.fixed( last_idx ) || bytes[ last_idx ] == buffer[ buffer_idx + last_idx ] )
             {
                 // Check the first byte
-                if ( !pattern.mask[ 0 ] || pattern.bytes[ 0 ] == buffer[ buffer_idx ] )
+                if ( !pattern.fixed( 0 ) || bytes[ 0 ] == buffer[ buffer_idx ] )
                 {
                     // Check the middle byte
-                    if ( !pattern.mask[ mid_idx ] || pattern.bytes[ mid_idx ] == buffer[ buffer_idx + mid_idx ] )
+                    if ( !pattern.fixed( mid_idx ) || bytes[ mid_idx ] == buffer[ buffer_idx + mid_idx ] )
                     {
                         // Now verify the rest of the pattern
-                        std::size_t pattern_idx = 1;
-                        while ( pattern_idx < last_idx &&
-                                ( !pattern.mask[ pattern_idx ] || pattern.bytes[ pattern_idx ] == buffer[ buffer_idx + pattern_idx ] ) )
-                        {
-                            ++pattern_idx;
-                        }
-
-                        if ( pattern_idx == last_idx )
+                        if ( pattern.matches( buffer.data() + buffer_idx ) )
                         {
                             return buffer_idx;  // Full pattern match
                         }
@@ -209,4 +431,38 @@ namespace wincpp::patterns
         return -1;  // No match found
     }
 
+    template<>
+    std::int64_t scanner::index_of< scanner::algorithm_t::simd_t >( const context_t& context, const std::span< std::uint8_t >& buffer ) noexcept
+    {
+        const auto& pattern = context.pattern;
+
+        if ( pattern.size() == 0 || buffer.size() == 0 || pattern.size() > buffer.size() )
+        {
+            return -1;
+        }
+
+        anchors_t anchors;
+
+        // A pattern made of wildcards matches at the very start.
+        if ( !select_anchors( pattern, anchors ) )
+        {
+            return 0;
+        }
+
+        // The last start position where the pattern still fits.
+        const auto stop = buffer.size() - pattern.size();
+
+#if defined( WINCPP_X86 )
+        const auto& cpu = core::cpu_features_t::get();
+
+        if ( cpu.avx2 )
+            return scan_avx2( pattern, anchors, buffer.data(), stop );
+
+        if ( cpu.sse42 )
+            return scan_sse42( pattern, anchors, buffer.data(), stop );
+#endif
+
+        return scan_scalar( pattern, anchors, buffer.data(), 0, stop );
+    }
+
 }  // namespace wincpp::patterns
\ No newline at end of file